@@ -6,6 +6,8 @@
 // KMP算法匹配器（子类）
 class KMPMatcher : public StringMatcher {
 public:
+    using StringMatcher::match;
+
     // 实现文本匹配接口
     void match(const std::string& text, const std::string& pattern, std::vector<size_t>& positions) override;
 
@@ -0,0 +1,40 @@
+#pragma once
+#include "string_matcher.h"
+#include "kmp_matcher.h"
+#include "packed_text.h"
+#include <vector>
+#include <string>
+#include <omp.h>
+#include <iostream>
+
+// 小字母表匹配器：文本与模式串压缩为Bits位编码，每次比较一个64位字内的多个符号
+// 输入含字母表外字符时退回KMP匹配，位置始终以原始符号为单位
+template <int Bits>
+class PackedMatcher : public StringMatcher {
+public:
+    using StringMatcher::match;
+
+    explicit PackedMatcher(const std::string& alphabet = PackedText<Bits>::DefaultAlphabet());
+
+    void match(const std::string& text, const std::string& pattern, std::vector<size_t>& positions) override;
+    void match(const std::string& text, const std::string& pattern, PositionList& positions) override;
+
+    // 按本匹配器的字母表编码文本，编码结果由调用者持有；含字母表外字符时返回false
+    bool Prepare(const std::string& text, PackedText<Bits>& packed) const;
+
+    // 已编码文本的匹配，便于同一文本匹配多个模式串时只编码一次
+    void match(const PackedText<Bits>& text, const PackedText<Bits>& pattern, std::vector<size_t>& positions);
+    // 已编码文本与原始模式串的匹配，Offset32编码下直接填充32位偏移
+    void match(const PackedText<Bits>& text, const std::string& pattern, PositionList& positions);
+
+private:
+    std::string alphabet;
+    KMPMatcher fallback;
+
+    template <typename T>
+    void Collect(const PackedText<Bits>& text, const PackedText<Bits>& pattern, std::vector<T>& positions);
+    bool MatchAt(const PackedText<Bits>& text, size_t pos, const std::vector<uint64_t>& pw, uint64_t last_mask);
+
+public:
+    void Test_PackedMatch();
+};
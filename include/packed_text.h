@@ -0,0 +1,44 @@
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+#include <string>
+#include <vector>
+
+// 小字母表文本的压缩表示，每个符号占Bits位（2或4），按64位字打包
+template <int Bits>
+class PackedText {
+    static_assert(Bits == 2 || Bits == 4, "PackedText仅支持2位或4位编码");
+
+public:
+    static constexpr size_t kSymbolsPerWord = 64 / Bits;
+    static constexpr size_t kAlphabetSize = size_t(1) << Bits;
+
+    // 默认字母表：2位为ACGT，4位为IUPAC核苷酸代码
+    static std::string DefaultAlphabet();
+
+    explicit PackedText(const std::string& alphabet = DefaultAlphabet());
+
+    // 并行编码文本，遇到字母表外符号时尽快停止、释放缓冲区并返回false
+    bool encode(const std::string& text);
+
+    size_t size() const { return length; }
+    const std::vector<uint64_t>& data() const { return words; }
+
+    // 取从第pos个符号开始的64位窗口（低位为前面的符号）
+    uint64_t window(size_t pos) const {
+        size_t bit = pos * Bits;
+        size_t w = bit / 64;
+        size_t off = bit % 64;
+        uint64_t val = words[w] >> off;
+        if (off) {
+            val |= words[w + 1] << (64 - off);
+        }
+        return val;
+    }
+
+private:
+    int8_t table[256];            // 字符 -> 编码，-1表示不在字母表中
+    std::vector<uint64_t> words;  // 末尾额外保留一个全零字，便于跨字读取窗口
+    size_t length = 0;
+};
@@ -10,18 +10,24 @@
 class ParallelMatcher : public StringMatcher{
 public:
     void match(const std::string& text, const std::string& pattern, std::vector<size_t>& positions) override;
+    void match(const std::string& text, const std::string& pattern, PositionList& positions) override;
 
 private:
     std::map<std::string, std::vector<int>> wit_map;
     std::vector<int> GetWitnessArray(const std::string& pattern);
-    int Duel(int i, int j, const std::string& z, const std::string& y, std::vector<int>& witness);
+    long long Duel(long long i, long long j, const std::string& z, const std::string& y, std::vector<int>& witness);
     void MatchNonPeriodic(const std::string& text, const std::string& pattern, std::vector<size_t>& positions,  std::vector<int>& wit);
     void MatchPeriodic(const std::string& text, const std::string& pattern, std::vector<size_t>& positions,  std::vector<int>& wit, int periodic);
     int GetPeriodicIndex(std::vector<int>& wit);
+    void GetDuelPattern(const std::string& pattern, std::string& dp, std::vector<int>& dwit);
+    long long BlockWinner(long long i, const std::string& text, const std::string& pattern, const std::string& dp, std::vector<int>& dwit);
+    template <typename T>
+    void CollectTwoPass(const std::string& text, const std::string& pattern, const std::string& dp, std::vector<int>& dwit, std::vector<T>& positions);
 
 public:
     void Test_GetWitnessArray();
     void Test_Duel(int i, int j);
     void Test_MatchNonPeriodic();
     void Test_ParallelMatch();
+    void Test_TwoPass();
 };
\ No newline at end of file
@@ -0,0 +1,78 @@
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+#include <vector>
+
+// 紧凑的匹配位置容器
+// 文本小于4GB时以32位偏移存储；否则按块存储差分+varint编码
+class PositionList {
+public:
+    enum class Encoding {
+        Offset32,    // 每个位置4字节
+        DeltaVarint  // 块内差分后varint编码，要求位置升序
+    };
+
+    // 每个varint块包含的位置个数
+    static constexpr size_t kBlockSize = 128;
+
+    // 根据文本长度自动选择编码
+    explicit PositionList(size_t text_size = 0);
+    PositionList(size_t text_size, Encoding encoding);
+
+    Encoding encoding() const { return encoding_; }
+    size_t size() const { return count_; }
+    bool empty() const { return count_ == 0; }
+    // 位置数据实际占用的字节数
+    size_t bytes() const;
+
+    void clear();
+    // 追加一个位置（DeltaVarint编码下必须不小于上一个位置）
+    void push_back(size_t pos);
+    // 用给定位置替换全部内容（DeltaVarint编码下若无序则先排序）
+    void assign(const std::vector<size_t>& positions);
+    // 直接接管已填好的32位偏移数组（仅Offset32编码）
+    void adopt(std::vector<uint32_t>&& offsets);
+
+    // 随机访问，DeltaVarint编码下需解码所在块
+    size_t at(size_t index) const;
+    // 解码为普通位置数组
+    void decode(std::vector<size_t>& positions) const;
+
+    // 按顺序遍历全部位置
+    template <typename Func>
+    void forEach(Func&& func) const {
+        if (encoding_ == Encoding::Offset32) {
+            for (uint32_t pos : offsets_) {
+                func(static_cast<size_t>(pos));
+            }
+            return;
+        }
+        for (size_t b = 0; b < block_base_.size(); ++b) {
+            size_t begin = block_start_[b];
+            size_t end = b + 1 < block_start_.size() ? block_start_[b + 1] : data_.size();
+            size_t pos = block_base_[b];
+            func(pos);
+            while (begin < end) {
+                pos += readVarint(begin);
+                func(pos);
+            }
+        }
+    }
+
+private:
+    Encoding encoding_;
+    size_t count_ = 0;
+
+    // Offset32编码数据
+    std::vector<uint32_t> offsets_;
+
+    // DeltaVarint编码数据：每块首个位置原样存储，其余为与前一位置的差值
+    std::vector<uint64_t> block_base_;   // 各块首位置
+    std::vector<size_t> block_start_;    // 各块差值在data_中的起始字节
+    std::vector<uint8_t> data_;          // varint字节流
+    size_t last_ = 0;                    // 最近追加的位置
+
+    void writeVarint(uint64_t value);
+    uint64_t readVarint(size_t& offset) const;
+};
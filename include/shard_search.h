@@ -0,0 +1,45 @@
+#pragma once
+#include "string_matcher.h"
+#include "position_list.h"
+#include <cstddef>
+#include <map>
+#include <string>
+#include <vector>
+
+// 多进程分片检索：协调进程按字节数均衡地把文档集切分为若干分片，
+// 每个分片由一个本地工作进程（内部仍使用OpenMP匹配器）处理，
+// 匹配结果经共享内存环形缓冲区回传，不经过临时文件
+//
+// 工作进程通过重新执行当前程序（/proc/self/exe）启动，因此调用run()的程序必须在main()
+// 开头处理kWorkerFlag，例如：
+//     if (argc == 4 && std::string(argv[1]) == ShardedSearch::kWorkerFlag) {
+//         return ShardedSearch::RunWorker(argv[2], std::stoi(argv[3]), &matcher);
+//     }
+// 否则工作进程会执行宿主程序自身的main()
+class ShardedSearch {
+public:
+    // 工作进程的命令行标志：<程序> --shard-worker <共享内存名> <工作进程编号>
+    static constexpr const char* kWorkerFlag = "--shard-worker";
+
+    // workers为0时按NUMA节点数启动工作进程；ring_bytes为每个工作进程的环形缓冲区大小
+    explicit ShardedSearch(int workers = 0, size_t ring_bytes = 1 << 20);
+
+    // 检索全部文档，results: 文档路径 -> 各模式串的升序匹配位置（顺序同patterns）
+    // 位置以PositionList紧凑存储，4GB以内的文档按32位偏移传输；无法读取的文档不出现在results中
+    bool run(const std::vector<std::string>& documents, const std::vector<std::string>& patterns,
+             std::map<std::string, std::vector<PositionList>>& results);
+
+    // 按字节数均衡分片（大文件优先放入当前最轻的分片），返回各分片的文档下标
+    static std::vector<std::vector<size_t>> SplitShards(const std::vector<size_t>& sizes, int shards);
+
+    // 工作进程入口，由main在检测到kWorkerFlag时调用，返回进程退出码
+    static int RunWorker(const std::string& shm_name, int worker_id, StringMatcher* matcher);
+
+private:
+    int workers;
+    size_t ring_bytes;
+
+public:
+    void Test_SplitShards();
+    void Test_ShardedSearch();
+};
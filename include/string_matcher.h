@@ -1,5 +1,6 @@
 #pragma once
 
+#include "position_list.h"
 #include <string>
 #include <vector>
 
@@ -9,4 +10,11 @@ public:
     virtual ~StringMatcher() = default;
 
     virtual void match(const std::string& text, const std::string& pattern, std::vector<size_t>& positions) = 0;
+
+    // 以紧凑容器输出匹配位置，默认先匹配到普通数组再压缩
+    virtual void match(const std::string& text, const std::string& pattern, PositionList& positions) {
+        std::vector<size_t> raw;
+        match(text, pattern, raw);
+        positions.assign(raw);
+    }
 };
\ No newline at end of file
@@ -0,0 +1,42 @@
+#pragma once
+
+#include <cstddef>
+#include <vector>
+#include <omp.h>
+
+// 两遍收集匹配位置：[0, units)按线程切分为连续区间，第一遍计数，前缀和得到各线程的写入偏移，
+// 第二遍按精确大小预分配后由各线程无锁填充，结果升序。
+// emit(i, sink)须对第i个单元内的每个匹配位置按升序调用sink(pos)，两遍调用的结果必须一致
+template <typename T, typename Emit>
+void TwoPassCollect(long long units, bool parallel, Emit&& emit, std::vector<T>& positions) {
+    std::vector<size_t> offsets;
+    #pragma omp parallel if (parallel)
+    {
+        int tid = omp_get_thread_num();
+        int nt = omp_get_num_threads();
+        #pragma omp single
+        offsets.assign(nt + 1, 0);
+
+        long long begin = units * tid / nt;
+        long long end = units * (tid + 1) / nt;
+        size_t count = 0;
+        for (long long i = begin; i < end; ++i) {
+            emit(i, [&count](long long) { ++count; });
+        }
+        offsets[tid + 1] = count;
+        #pragma omp barrier
+
+        #pragma omp single
+        {
+            for (int t = 0; t < nt; ++t) {
+                offsets[t + 1] += offsets[t];
+            }
+            positions.resize(offsets[nt]);
+        }
+
+        size_t k = offsets[tid];
+        for (long long i = begin; i < end; ++i) {
+            emit(i, [&positions, &k](long long pos) { positions[k++] = static_cast<T>(pos); });
+        }
+    }
+}
@@ -1,5 +1,7 @@
 #include "kmp_matcher.h"
 #include "parallel_matcher.h"
+#include "packed_matcher.h"
+#include "shard_search.h"
 #include <iostream>
 #include <fstream>
 #include <filesystem>
@@ -8,6 +10,8 @@
 #include <map>
 #include <set>
 #include <ctime>
+#include <chrono>
+#include <algorithm>
 
 namespace fs = std::filesystem; // 目录遍历需C++17
 
@@ -74,15 +78,24 @@ void handleDocumentRetrieval(StringMatcher *matcher) {
         return;
     }
 
+    // 压缩匹配器：文档只编码一次，之后各模式串直接在压缩文本上匹配
+    auto *packed_matcher = dynamic_cast<PackedMatcher<2> *>(matcher);
+    PackedText<2> packed_document;
+    bool packed = packed_matcher && packed_matcher->Prepare(document, packed_document);
+
     // 逐个匹配模式串并输出结果
+    PositionList positions(document.size()); // 紧凑存储匹配位置
     for (const auto& pattern : patterns) {
-        std::vector<size_t> positions;
-        matcher->match(document, pattern, positions);
+        if (packed) {
+            packed_matcher->match(packed_document, pattern, positions);
+        } else {
+            matcher->match(document, pattern, positions);
+        }
         // 输出格式：次数 位置1 位置2 ...
         result_file << positions.size();
-        for (size_t pos : positions) {
+        positions.forEach([&result_file](size_t pos) {
             result_file << " " << pos;
-        }
+        });
         result_file << std::endl;
     }
 
@@ -190,11 +203,93 @@ void handleSoftwareAntivirus(StringMatcher *matcher) {
     std::cout << "场景2完成：结果已保存至 " << result_path << std::endl;
 }
 
-int main() {
+// 场景3：多文档分片检索（文档集目录不存在时跳过）
+void handleCorpusRetrieval() {
+    std::string data_path(DATA_PATH);
+    if (!data_path.empty() && data_path.back() == '/') {
+        data_path.pop_back();
+    }
+
+    const std::string corpus_dir = data_path + "/corpus_retrieval/documents";
+    const std::string target_path = data_path + "/corpus_retrieval/target.txt";
+    const std::string result_path = "../result_corpus.txt"; // 结果文件输出到项目根目录
+
+    if (!fs::is_directory(corpus_dir)) {
+        std::cout << "场景3跳过：未找到文档集 " << corpus_dir << std::endl;
+        return;
+    }
+
+    // 收集文档路径（按路径排序，决定结果输出顺序）
+    std::vector<std::string> documents;
+    try {
+        for (const auto& entry : fs::recursive_directory_iterator(corpus_dir)) {
+            if (entry.is_regular_file()) {
+                documents.push_back(entry.path().string());
+            }
+        }
+    } catch (const fs::filesystem_error& e) {
+        std::cerr << "Error: 访问文档集目录失败 " << e.what() << std::endl;
+        return;
+    }
+    std::sort(documents.begin(), documents.end());
+
+    // 读取模式串列表
+    std::vector<std::string> patterns;
+    std::ifstream target_file(target_path);
+    if (!target_file.is_open()) {
+        std::cerr << "Error: 无法打开模式串文件 " << target_path << std::endl;
+        return;
+    }
+    std::string line;
+    while (std::getline(target_file, line)) {
+        if (!line.empty()) { // 跳过空行
+            patterns.push_back(line);
+        }
+    }
+    target_file.close();
+
+    // 分片并由多个工作进程检索
+    ShardedSearch search;
+    std::map<std::string, std::vector<PositionList>> results;
+    if (!search.run(documents, patterns, results)) {
+        std::cerr << "Error: 分片检索失败" << std::endl;
+        return;
+    }
+
+    std::ofstream result_file(result_path, std::ios::out | std::ios::trunc);
+    if (!result_file.is_open()) {
+        std::cerr << "Error: 无法创建结果文件 " << result_path << std::endl;
+        return;
+    }
+
+    // 输出格式：每个文档先输出data/xxx路径，随后每个模式串一行：次数 位置1 位置2 ...
+    for (const auto& [doc_path, hits] : results) {
+        result_file << "data" << doc_path.substr(data_path.length()) << std::endl;
+        for (const auto& positions : hits) {
+            result_file << positions.size();
+            positions.forEach([&result_file](size_t pos) {
+                result_file << " " << pos;
+            });
+            result_file << std::endl;
+        }
+    }
+
+    result_file.close();
+    std::cout << "场景3完成：结果已保存至 " << result_path << std::endl;
+}
+
+int main(int argc, char* argv[]) {
     ParallelMatcher pm;
     // KMPMatcher pm;
-    // 执行两个业务场景
-    std::cout << "开始执行两个场景" << '\n';
+    // PackedMatcher<2> pm; // 基因组等仅含ACGT的数据
+
+    // 分片检索的工作进程入口
+    if (argc == 4 && std::string(argv[1]) == ShardedSearch::kWorkerFlag) {
+        return ShardedSearch::RunWorker(argv[2], std::stoi(argv[3]), &pm);
+    }
+
+    // 执行三个业务场景
+    std::cout << "开始执行三个场景" << '\n';
     clock_t start, end;
     start = clock();
     handleDocumentRetrieval(&pm);
@@ -206,5 +301,11 @@ int main() {
     end = clock();
     double scene2 = ((double) (end - start)) / CLOCKS_PER_SEC;
     std::cout << "场景2用时：" << scene2 << "s.\n";
+    // 场景3的匹配在工作进程中进行，clock()只统计协调进程的CPU时间，故使用墙钟时间
+    auto wall_start = std::chrono::steady_clock::now();
+    handleCorpusRetrieval();
+    auto wall_end = std::chrono::steady_clock::now();
+    double scene3 = std::chrono::duration<double>(wall_end - wall_start).count();
+    std::cout << "场景3用时：" << scene3 << "s.\n";
     return 0;
 }
\ No newline at end of file
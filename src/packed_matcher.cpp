@@ -0,0 +1,183 @@
+#include "packed_matcher.h"
+#include "two_pass_collect.h"
+#include <algorithm>
+
+template <int Bits>
+PackedMatcher<Bits>::PackedMatcher(const std::string& alphabet) : alphabet(alphabet) {}
+
+template <int Bits>
+bool PackedMatcher<Bits>::Prepare(const std::string& text, PackedText<Bits>& packed) const {
+    packed = PackedText<Bits>(alphabet);
+    return packed.encode(text);
+}
+
+template <int Bits>
+void PackedMatcher<Bits>::match(const std::string& text, const std::string& pattern, std::vector<size_t>& positions) {
+    positions.clear();
+    if (pattern.empty() || text.size() < pattern.size()) {
+        return;
+    }
+
+    PackedText<Bits> packed_text, packed_pattern;
+    if (!Prepare(pattern, packed_pattern) || !Prepare(text, packed_text)) {
+        // 存在字母表外字符，退回逐字节匹配
+        fallback.match(text, pattern, positions);
+        return;
+    }
+    Collect(packed_text, packed_pattern, positions);
+}
+
+template <int Bits>
+void PackedMatcher<Bits>::match(const std::string& text, const std::string& pattern, PositionList& positions) {
+    positions.clear();
+    if (pattern.empty() || text.size() < pattern.size()) {
+        return;
+    }
+
+    PackedText<Bits> packed_text;
+    if (!Prepare(text, packed_text)) {
+        fallback.match(text, pattern, positions);
+        return;
+    }
+    match(packed_text, pattern, positions);
+}
+
+template <int Bits>
+void PackedMatcher<Bits>::match(const PackedText<Bits>& text, const PackedText<Bits>& pattern, std::vector<size_t>& positions) {
+    Collect(text, pattern, positions);
+}
+
+template <int Bits>
+void PackedMatcher<Bits>::match(const PackedText<Bits>& text, const std::string& pattern, PositionList& positions) {
+    positions.clear();
+    PackedText<Bits> packed_pattern;
+    // 文本只含字母表符号，模式串含其他字符时不可能匹配
+    if (!Prepare(pattern, packed_pattern)) {
+        return;
+    }
+    if (positions.encoding() == PositionList::Encoding::Offset32) {
+        std::vector<uint32_t> offsets;
+        Collect(text, packed_pattern, offsets);
+        positions.adopt(std::move(offsets));
+    } else {
+        std::vector<size_t> raw;
+        Collect(text, packed_pattern, raw);
+        positions.assign(raw);
+    }
+}
+
+// 逐字验证：每个64位字同时比较64/Bits个符号，最后一个字只比较有效位
+template <int Bits>
+bool PackedMatcher<Bits>::MatchAt(const PackedText<Bits>& text, size_t pos, const std::vector<uint64_t>& pw, uint64_t last_mask) {
+    size_t k_last = pw.size() - 1;
+    for (size_t k = 0; k < k_last; ++k) {
+        if (text.window(pos + k * PackedText<Bits>::kSymbolsPerWord) != pw[k]) {
+            return false;
+        }
+    }
+    return ((text.window(pos + k_last * PackedText<Bits>::kSymbolsPerWord) ^ pw[k_last]) & last_mask) == 0;
+}
+
+// 同时检查一个字内的全部起点：第b块覆盖起点[b*S, b*S+S)，对模式串前L个符号，
+// 把文本窗口右移k个符号后与第k个符号的重复编码异或，全零的符号槽即该起点第k个符号匹配；
+// 各k的结果相与得到候选起点，模式串长于L时再逐字验证。两遍收集，结果升序
+template <int Bits>
+template <typename T>
+void PackedMatcher<Bits>::Collect(const PackedText<Bits>& text, const PackedText<Bits>& pattern, std::vector<T>& positions) {
+    positions.clear();
+    size_t n = text.size();
+    size_t m = pattern.size();
+    if (m == 0 || n < m) {
+        return;
+    }
+
+    constexpr size_t S = PackedText<Bits>::kSymbolsPerWord;
+    constexpr uint64_t kCodeMask = PackedText<Bits>::kAlphabetSize - 1;
+    constexpr uint64_t kLanes = ~uint64_t(0) / kCodeMask;  // 每个符号槽的最低位
+    constexpr size_t kFilter = 8;                          // 参与字内过滤的前缀符号数
+
+    size_t word_count = (m + S - 1) / S;
+    std::vector<uint64_t> pw(pattern.data().begin(), pattern.data().begin() + word_count);
+    size_t tail_bits = (m - (word_count - 1) * S) * Bits;
+    uint64_t last_mask = tail_bits == 64 ? ~uint64_t(0) : (uint64_t(1) << tail_bits) - 1;
+
+    // 前缀符号在每个槽中的重复编码
+    size_t filter = std::min(m, kFilter);
+    uint64_t rep[kFilter];
+    for (size_t k = 0; k < filter; ++k) {
+        rep[k] = ((pw[k / S] >> (k % S * Bits)) & kCodeMask) * kLanes;
+    }
+
+    const std::vector<uint64_t>& words = text.data();
+    long long last_start = n - m;
+    long long blocks = last_start / S + 1;
+    TwoPassCollect(blocks, n - m > 1000, [&](long long b, auto&& sink) {
+        uint64_t lo = words[b], hi = words[b + 1];
+        uint64_t hits = kLanes;
+        for (size_t k = 0; k < filter && hits; ++k) {
+            uint64_t w = k ? (lo >> (k * Bits)) | (hi << (64 - k * Bits)) : lo;
+            uint64_t x = w ^ rep[k];
+            uint64_t diff = x;
+            for (int t = 1; t < Bits; ++t) {
+                diff |= x >> t;
+            }
+            hits &= ~diff;
+        }
+        // 去掉超出最后一个合法起点的槽
+        long long lanes = std::min<long long>(S, last_start - b * (long long)S + 1);
+        if (lanes < (long long)S) {
+            hits &= (uint64_t(1) << (lanes * Bits)) - 1;
+        }
+        while (hits) {
+            long long pos = b * (long long)S + __builtin_ctzll(hits) / Bits;
+            hits &= hits - 1;
+            if (m <= filter || MatchAt(text, pos, pw, last_mask)) {
+                sink(pos);
+            }
+        }
+    }, positions);
+}
+
+// 随机文本与模式串，与KMPMatcher的结果逐一比较，覆盖跨字模式串、预编码+PositionList路径与字母表外字符的回退
+template <int Bits>
+void PackedMatcher<Bits>::Test_PackedMatch() {
+    std::cout << "Testing Packed Match (" << Bits << " bits).\n";
+    KMPMatcher kmp;
+    uint32_t seed = 4096 + Bits;
+    auto next = [&seed]() { seed = seed * 1103515245 + 12345; return (seed >> 16) & 0x7fff; };
+    size_t cases = 0, total = 0, mismatches = 0;
+    for (int round = 0; round < 300; ++round) {
+        // 只用字母表的前几个符号，使短模式串频繁命中；部分文本足够长以启用并行
+        size_t symbols = 1 + next() % std::min<size_t>(alphabet.size(), 4);
+        size_t n = round % 10 == 0 ? 2000 + next() % 20000 : 1 + next() % 300;
+        size_t m = 1 + next() % (round % 3 == 0 ? 80 : 12);
+        std::string t(n, ' '), p(m, ' ');
+        for (char& c : t) c = alphabet[next() % symbols];
+        for (char& c : p) c = alphabet[next() % symbols];
+        // 少量用例混入字母表外字符，应退回KMP且结果不变
+        if (round % 25 == 1) {
+            t[next() % n] = 'x';
+        } else if (round % 25 == 2) {
+            p[next() % m] = 'x';
+        }
+
+        std::vector<size_t> expected, actual, decoded;
+        kmp.match(t, p, expected);
+        match(t, p, actual);
+        PackedText<Bits> packed;
+        PositionList compact(t.size());
+        if (Prepare(t, packed)) {
+            match(packed, p, compact);
+        } else {
+            match(t, p, compact);
+        }
+        compact.decode(decoded);
+        ++cases;
+        total += expected.size();
+        mismatches += (expected != actual) + (expected != decoded);
+    }
+    std::cout << "cases: " << cases << ", hits: " << total << ", mismatches: " << mismatches << '\n';
+}
+
+template class PackedMatcher<2>;
+template class PackedMatcher<4>;
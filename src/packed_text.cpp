@@ -0,0 +1,60 @@
+#include "packed_text.h"
+#include <atomic>
+#include <omp.h>
+
+template <int Bits>
+std::string PackedText<Bits>::DefaultAlphabet() {
+    if (Bits == 2) {
+        return "ACGT";
+    }
+    return "ACGTURYSWKMBDHVN";
+}
+
+template <int Bits>
+PackedText<Bits>::PackedText(const std::string& alphabet) {
+    for (int c = 0; c < 256; ++c) {
+        table[c] = -1;
+    }
+    // 超出容量的字母表符号被忽略
+    for (size_t i = 0; i < alphabet.size() && i < kAlphabetSize; ++i) {
+        table[static_cast<unsigned char>(alphabet[i])] = static_cast<int8_t>(i);
+    }
+}
+
+template <int Bits>
+bool PackedText<Bits>::encode(const std::string& text) {
+    length = text.size();
+    long long word_count = (length + kSymbolsPerWord - 1) / kSymbolsPerWord;
+    words.assign(word_count + 1, 0);
+
+    // 每个线程独立打包若干个完整的字；任一线程发现非法符号后其余字直接跳过
+    std::atomic<bool> invalid(false);
+    #pragma omp parallel for if (length > 100000)
+    for (long long w = 0; w < word_count; ++w) {
+        if (invalid.load(std::memory_order_relaxed)) {
+            continue;
+        }
+        size_t begin = w * kSymbolsPerWord;
+        size_t end = begin + kSymbolsPerWord < length ? begin + kSymbolsPerWord : length;
+        uint64_t word = 0;
+        for (size_t i = begin; i < end; ++i) {
+            int c = table[static_cast<unsigned char>(text[i])];
+            if (c < 0) {
+                invalid.store(true, std::memory_order_relaxed);
+                break;
+            }
+            word |= static_cast<uint64_t>(c) << ((i - begin) * Bits);
+        }
+        words[w] = word;
+    }
+    if (invalid.load()) {
+        words.clear();
+        words.shrink_to_fit();
+        length = 0;
+        return false;
+    }
+    return true;
+}
+
+template class PackedText<2>;
+template class PackedText<4>;
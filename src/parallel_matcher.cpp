@@ -1,6 +1,8 @@
 #include "parallel_matcher.h"
+#include "two_pass_collect.h"
+#include "kmp_matcher.h"
 
-// 并行匹配
+// 并行匹配：两遍收集，先并行计数，再按精确大小预分配并由各线程无锁写入，结果升序
 void ParallelMatcher::match(const std::string& text, const std::string& pattern, std::vector<size_t>& positions){
     positions.clear();
     size_t n = text.size();
@@ -9,15 +11,33 @@ void ParallelMatcher::match(const std::string& text, const std::string& pattern,
         return;
     }
 
-    std::vector<int> wit = GetWitnessArray(pattern);
-    int periodic = GetPeriodicIndex(wit);
-    if (!periodic){
-        // 非周期串
-        MatchNonPeriodic(text, pattern, positions, wit);
-    } else{
-        // 周期串
-        MatchPeriodic(text, pattern, positions, wit, periodic);
+    std::string dp;
+    std::vector<int> dwit;
+    GetDuelPattern(pattern, dp, dwit);
+    CollectTwoPass(text, pattern, dp, dwit, positions);
+}
+
+// 紧凑输出：直接填充32位偏移，避免中间的size_t数组
+void ParallelMatcher::match(const std::string& text, const std::string& pattern, PositionList& positions){
+    positions.clear();
+    if (positions.encoding() != PositionList::Encoding::Offset32){
+        std::vector<size_t> raw;
+        match(text, pattern, raw);
+        positions.assign(raw);
+        return;
+    }
+    size_t n = text.size();
+    size_t m = pattern.size();
+    if (m == 0 || n < m) {
+        return;
     }
+
+    std::string dp;
+    std::vector<int> dwit;
+    GetDuelPattern(pattern, dp, dwit);
+    std::vector<uint32_t> offsets;
+    CollectTwoPass(text, pattern, dp, dwit, offsets);
+    positions.adopt(std::move(offsets));
 }
 
 std::vector<int> ParallelMatcher::GetWitnessArray(const std::string& pattern){
@@ -65,70 +85,23 @@ std::vector<int> ParallelMatcher::GetWitnessArray(const std::string& pattern){
     return wit;
 }
 
-int ParallelMatcher::Duel(int i, int j, const std::string& z, const std::string& y, std::vector<int>& witness){
+// 下标使用long long，支持2GB以上的文本
+long long ParallelMatcher::Duel(long long i, long long j, const std::string& z, const std::string& y, std::vector<int>& witness){
     // j - i + 1 不能超过wit大小
     int k = witness[j-i];
     return z[j+k-2] != y[k-1] ? i : j;
 }
 
 void ParallelMatcher::MatchNonPeriodic(const std::string& text, const std::string& pattern, std::vector<size_t>& positions,  std::vector<int>& wit){
-    int n = text.size();
-    int m = pattern.size();
-    int d = wit.size();
     // 在d个下标中决出胜者，并判断是否匹配
-    #pragma omp parallel for if (n-m > 1000)
-    for (int i = 0; i < (n-m+1)/d; ++i){
-        int winner = i*d;
-        for (int j = 1; j < d; ++j){
-            if (i*d+j < n-m+1){
-                winner = Duel(winner, i*d+j, text, pattern, wit);
-            }
-        }
-        int match = 1;
-        for (int j = 0; j < m; ++j){
-            if (text[winner+j-1] != pattern[j]){
-                match = 0;
-                break;
-            }
-        }
-        if (match) {
-            #pragma omp critical
-            {
-                positions.push_back(winner-1);
-            }
-        }
-    }
+    CollectTwoPass(text, pattern, pattern, wit, positions);
 }
 
 void ParallelMatcher::MatchPeriodic(const std::string& text, const std::string& pattern, std::vector<size_t>& positions,  std::vector<int>& wit, int periodic){
-    std::string npp(pattern.begin(), pattern.begin()+periodic-1); // [1, periodic-1]
+    // 以非周期前缀[1, periodic-1]决斗，再验证完整模式串
+    std::string npp(pattern.begin(), pattern.begin()+periodic-1);
     std::vector<int> npwit = GetWitnessArray(npp);
-    int n = text.size();
-    int pm = pattern.size();
-    int m = npp.size();
-    int d = npwit.size();
-    #pragma omp parallel for if (n-m > 1000)
-    for (int i = 0; i < (n-m+1)/d; ++i){
-        int winner = i*d;
-        for (int j = 1; j < d; ++j){
-            if (i*d+j < n-m+1){
-                winner = Duel(winner, i*d+j, text, npp, npwit);
-            }
-        }
-        int match = 1;
-        for (int j = 0; j < pm; ++j){
-            if (text[winner+j-1] != pattern[j]){
-                match = 0;
-                break;
-            }
-        }
-        if (match) {
-            #pragma omp critical
-            {
-                positions.push_back(winner-1);
-            }
-        }
-    }
+    CollectTwoPass(text, pattern, npp, npwit, positions);
 }
 
 int ParallelMatcher::GetPeriodicIndex(std::vector<int>& wit){
@@ -147,6 +120,59 @@ int ParallelMatcher::GetPeriodicIndex(std::vector<int>& wit){
         return i;
 }
 
+// 决斗所用的模式串：非周期串为其本身，周期串为其非周期前缀
+void ParallelMatcher::GetDuelPattern(const std::string& pattern, std::string& dp, std::vector<int>& dwit){
+    std::vector<int> wit = GetWitnessArray(pattern);
+    int periodic = GetPeriodicIndex(wit);
+    if (!periodic){
+        dp = pattern;
+        dwit = wit;
+    } else{
+        dp.assign(pattern.begin(), pattern.begin()+periodic-1);
+        dwit = GetWitnessArray(dp);
+    }
+}
+
+// 在第i块的d个下标中决出胜者并验证，匹配时返回胜者，否则返回-1
+long long ParallelMatcher::BlockWinner(long long i, const std::string& text, const std::string& pattern, const std::string& dp, std::vector<int>& dwit){
+    long long n = text.size();
+    long long pm = pattern.size();
+    long long m = dp.size();
+    long long d = dwit.size();
+    // 第i块的候选起点为[i*d+1, i*d+d]（从1开始），不超过n-m+1
+    long long winner = i*d+1;
+    for (long long j = 2; j <= d; ++j){
+        if (i*d+j <= n-m+1){
+            winner = Duel(winner, i*d+j, text, dp, dwit);
+        }
+    }
+    // 周期串的胜者可能容得下前缀却容不下完整模式串
+    if (winner-1+pm > n){
+        return -1;
+    }
+    for (long long j = 0; j < pm; ++j){
+        if (text[winner+j-1] != pattern[j]){
+            return -1;
+        }
+    }
+    return winner;
+}
+
+// 两遍收集：每个决斗块至多产生一个匹配位置
+template <typename T>
+void ParallelMatcher::CollectTwoPass(const std::string& text, const std::string& pattern, const std::string& dp, std::vector<int>& dwit, std::vector<T>& positions){
+    long long n = text.size();
+    long long m = dp.size();
+    long long d = dwit.size();
+    long long blocks = (n-m+1+d-1)/d;
+    TwoPassCollect(blocks, n-m > 1000, [&](long long i, auto&& sink){
+        long long winner = BlockWinner(i, text, pattern, dp, dwit);
+        if (winner >= 0){
+            sink(winner-1);
+        }
+    }, positions);
+}
+
 void ParallelMatcher::Test_GetWitnessArray(){
     std::cout << "Testing Witness Array.\n";
     
@@ -165,7 +191,7 @@ void ParallelMatcher::Test_Duel(int i, int j){
     const std::string t = "abaababaababaababaababa";
     const std::string p= "abaababa";
     std::vector<int> wit = GetWitnessArray(p);
-    int winner = Duel(i, j, t, p, wit);
+    long long winner = Duel(i, j, t, p, wit);
     std::cout << "Winner of " << i << " and " << j << " is: " << winner << '\n';
 }
 
@@ -194,3 +220,38 @@ void ParallelMatcher::Test_ParallelMatch(){
     std::cout << '\n';
 }
 
+// 随机文本与模式串，与KMPMatcher的结果逐一比较，覆盖周期串、不完整的末块与PositionList输出
+void ParallelMatcher::Test_TwoPass(){
+    std::cout << "Testing Two Pass Match.\n";
+    KMPMatcher kmp;
+    uint32_t seed = 2024;
+    auto next = [&seed](){ seed = seed * 1103515245 + 12345; return (seed >> 16) & 0x7fff; };
+    size_t cases = 0, total = 0, mismatches = 0;
+    for (int round = 0; round < 300; ++round){
+        // 小字母表使周期串与大量重叠匹配频繁出现；部分文本足够长以启用并行
+        size_t alphabet = 1 + next() % 3;
+        size_t n = round % 10 == 0 ? 2000 + next() % 20000 : 1 + next() % 200;
+        size_t m = 1 + next() % 16;
+        std::string t(n, ' '), p(m, ' ');
+        for (char& c : t) c = "abc"[next() % alphabet];
+        for (char& c : p) c = "abc"[next() % alphabet];
+
+        std::vector<size_t> expected, actual, decoded;
+        kmp.match(t, p, expected);
+        match(t, p, actual);
+        PositionList compact(t.size());
+        match(t, p, compact);
+        compact.decode(decoded);
+        ++cases;
+        total += expected.size();
+        mismatches += (expected != actual) + (expected != decoded);
+    }
+    // 变长编码的往返
+    std::vector<size_t> positions, decoded;
+    match("abcabcabcabccbacbacbacbabcabcabcabcabc", "abcabcabcabc", positions);
+    PositionList varint(38, PositionList::Encoding::DeltaVarint);
+    varint.assign(positions);
+    varint.decode(decoded);
+    mismatches += positions != decoded;
+    std::cout << "cases: " << cases << ", hits: " << total << ", mismatches: " << mismatches << '\n';
+}
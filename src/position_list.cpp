@@ -0,0 +1,127 @@
+#include "position_list.h"
+#include <algorithm>
+#include <cassert>
+#include <limits>
+
+namespace {
+// 文本长度不超过该值时，所有位置都可用32位表示
+constexpr size_t kOffset32Limit = static_cast<size_t>(std::numeric_limits<uint32_t>::max()) + 1;
+}
+
+PositionList::PositionList(size_t text_size)
+    : encoding_(text_size <= kOffset32Limit ? Encoding::Offset32 : Encoding::DeltaVarint) {}
+
+PositionList::PositionList(size_t text_size, Encoding encoding) : encoding_(encoding) {
+    // 文本过长时32位偏移无法表示，退回varint编码
+    if (encoding_ == Encoding::Offset32 && text_size > kOffset32Limit) {
+        encoding_ = Encoding::DeltaVarint;
+    }
+}
+
+size_t PositionList::bytes() const {
+    if (encoding_ == Encoding::Offset32) {
+        return offsets_.size() * sizeof(uint32_t);
+    }
+    return data_.size() + block_base_.size() * (sizeof(uint64_t) + sizeof(size_t));
+}
+
+void PositionList::clear() {
+    count_ = 0;
+    last_ = 0;
+    offsets_.clear();
+    block_base_.clear();
+    block_start_.clear();
+    data_.clear();
+}
+
+void PositionList::push_back(size_t pos) {
+    if (encoding_ == Encoding::Offset32) {
+        assert(pos <= std::numeric_limits<uint32_t>::max());
+        offsets_.push_back(static_cast<uint32_t>(pos));
+    } else if (count_ % kBlockSize == 0) {
+        // 开启新块，首位置原样存储
+        assert(count_ == 0 || pos >= last_);
+        block_base_.push_back(pos);
+        block_start_.push_back(data_.size());
+    } else {
+        assert(pos >= last_);
+        writeVarint(pos - last_);
+    }
+    last_ = pos;
+    ++count_;
+}
+
+void PositionList::assign(const std::vector<size_t>& positions) {
+    clear();
+    if (encoding_ == Encoding::Offset32) {
+        offsets_.reserve(positions.size());
+        for (size_t pos : positions) {
+            push_back(pos);
+        }
+        return;
+    }
+    // 差分编码要求升序
+    if (std::is_sorted(positions.begin(), positions.end())) {
+        for (size_t pos : positions) {
+            push_back(pos);
+        }
+    } else {
+        std::vector<size_t> sorted(positions);
+        std::sort(sorted.begin(), sorted.end());
+        for (size_t pos : sorted) {
+            push_back(pos);
+        }
+    }
+}
+
+void PositionList::adopt(std::vector<uint32_t>&& offsets) {
+    assert(encoding_ == Encoding::Offset32);
+    clear();
+    offsets_ = std::move(offsets);
+    count_ = offsets_.size();
+    if (count_ > 0) {
+        last_ = offsets_.back();
+    }
+}
+
+size_t PositionList::at(size_t index) const {
+    assert(index < count_);
+    if (encoding_ == Encoding::Offset32) {
+        return offsets_[index];
+    }
+    // 定位所在块，再顺序解码块内差值
+    size_t b = index / kBlockSize;
+    size_t offset = block_start_[b];
+    size_t pos = block_base_[b];
+    for (size_t k = 0; k < index % kBlockSize; ++k) {
+        pos += readVarint(offset);
+    }
+    return pos;
+}
+
+void PositionList::decode(std::vector<size_t>& positions) const {
+    positions.clear();
+    positions.reserve(count_);
+    forEach([&positions](size_t pos) { positions.push_back(pos); });
+}
+
+void PositionList::writeVarint(uint64_t value) {
+    // 每字节低7位存数据，最高位表示后续还有字节
+    while (value >= 0x80) {
+        data_.push_back(static_cast<uint8_t>(value | 0x80));
+        value >>= 7;
+    }
+    data_.push_back(static_cast<uint8_t>(value));
+}
+
+uint64_t PositionList::readVarint(size_t& offset) const {
+    uint64_t value = 0;
+    int shift = 0;
+    uint8_t byte;
+    do {
+        byte = data_[offset++];
+        value |= static_cast<uint64_t>(byte & 0x7f) << shift;
+        shift += 7;
+    } while (byte & 0x80);
+    return value;
+}
@@ -0,0 +1,628 @@
+#include "shard_search.h"
+#include "kmp_matcher.h"
+#include <algorithm>
+#include <atomic>
+#include <cctype>
+#include <cerrno>
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <new>
+#include <omp.h>
+#include <fcntl.h>
+#include <sched.h>
+#include <signal.h>
+#include <spawn.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+extern char** environ;
+
+namespace fs = std::filesystem;
+
+namespace {
+
+constexpr uint64_t kMagic = 0x44524148534d5350ULL; // "PSMSHARD"
+
+static_assert(std::atomic<uint64_t>::is_always_lock_free, "跨进程环形缓冲区需要无锁原子操作");
+static_assert(sizeof(size_t) == sizeof(uint64_t), "大文档的位置按64位传输");
+
+// 文档长度不超过该值时，位置按32位偏移传输
+constexpr size_t kOffset32Limit = static_cast<size_t>(UINT32_MAX) + 1;
+
+// 共享内存头部
+struct ShmHeader {
+    uint64_t magic;
+    uint64_t workers;
+    uint64_t ring_bytes;
+    uint64_t rings_offset;
+    uint64_t job_offset;
+    uint64_t job_bytes;
+    uint64_t coordinator;  // 协调进程pid，工作进程据此发现协调进程退出
+};
+
+// 单生产者单消费者环形缓冲区，head/tail为累计读写字节数，分处不同缓存行
+struct alignas(64) RingHeader {
+    std::atomic<uint64_t> head;
+    char pad[64 - sizeof(std::atomic<uint64_t>)];
+    std::atomic<uint64_t> tail;
+};
+
+// 一条匹配记录，后接count个width字节（4或8）的升序位置；同一(文档,模式串)的位置可能分多条依次发送
+struct HitRecord {
+    uint32_t doc;
+    uint32_t pattern;
+    uint32_t count;
+    uint32_t width;
+};
+
+// pattern取此值的记录表示该文档读取失败，不带位置
+constexpr uint32_t kFailedDocument = UINT32_MAX;
+
+size_t AlignUp(size_t value, size_t align) {
+    return (value + align - 1) / align * align;
+}
+
+RingHeader* RingAt(char* base, const ShmHeader* header, int w) {
+    return reinterpret_cast<RingHeader*>(base + header->rings_offset + w * (sizeof(RingHeader) + header->ring_bytes));
+}
+
+char* RingData(RingHeader* ring) {
+    return reinterpret_cast<char*>(ring) + sizeof(RingHeader);
+}
+
+void CopyIn(char* data, size_t cap, uint64_t pos, const void* src, size_t bytes) {
+    size_t off = pos & (cap - 1);
+    size_t first = std::min(bytes, cap - off);
+    std::memcpy(data + off, src, first);
+    std::memcpy(data, static_cast<const char*>(src) + first, bytes - first);
+}
+
+void CopyOut(void* dst, const char* data, size_t cap, uint64_t pos, size_t bytes) {
+    size_t off = pos & (cap - 1);
+    size_t first = std::min(bytes, cap - off);
+    std::memcpy(dst, data + off, first);
+    std::memcpy(static_cast<char*>(dst) + first, data, bytes - first);
+}
+
+// 协调进程退出后工作进程会被init等进程收养
+bool CoordinatorAlive(pid_t coordinator) {
+    return getppid() == coordinator;
+}
+
+// 写入一条完整记录后再发布head，缓冲区满时等待协调进程消费；协调进程已退出时返回false
+bool PushRecord(RingHeader* ring, size_t cap, const HitRecord& rec, const void* positions, pid_t coordinator) {
+    size_t bytes = sizeof(HitRecord) + static_cast<size_t>(rec.count) * rec.width;
+    uint64_t head = ring->head.load(std::memory_order_relaxed);
+    while (cap - (head - ring->tail.load(std::memory_order_acquire)) < bytes) {
+        if (!CoordinatorAlive(coordinator)) {
+            return false;
+        }
+        usleep(50);
+    }
+    CopyIn(RingData(ring), cap, head, &rec, sizeof(HitRecord));
+    if (rec.count > 0) {
+        CopyIn(RingData(ring), cap, head + sizeof(HitRecord), positions, bytes - sizeof(HitRecord));
+    }
+    ring->head.store(head + bytes, std::memory_order_release);
+    return true;
+}
+
+// 取出已发布的全部记录并追加到hits，读取失败的文档记入failed，返回是否取到数据
+bool DrainRing(RingHeader* ring, size_t cap, std::vector<std::vector<PositionList>>& hits, std::vector<char>& failed) {
+    uint64_t tail = ring->tail.load(std::memory_order_relaxed);
+    uint64_t head = ring->head.load(std::memory_order_acquire);
+    if (tail == head) {
+        return false;
+    }
+    while (tail < head) {
+        HitRecord rec;
+        CopyOut(&rec, RingData(ring), cap, tail, sizeof(HitRecord));
+        if (rec.pattern == kFailedDocument) {
+            failed[rec.doc] = 1;
+            tail += sizeof(HitRecord);
+            continue;
+        }
+        PositionList& out = hits[rec.doc][rec.pattern];
+        uint64_t pos = tail + sizeof(HitRecord);
+        for (uint32_t i = 0; i < rec.count; ++i, pos += rec.width) {
+            if (rec.width == sizeof(uint32_t)) {
+                uint32_t value;
+                CopyOut(&value, RingData(ring), cap, pos, sizeof(value));
+                out.push_back(value);
+            } else {
+                uint64_t value;
+                CopyOut(&value, RingData(ring), cap, pos, sizeof(value));
+                out.push_back(value);
+            }
+        }
+        tail = pos;
+    }
+    ring->tail.store(tail, std::memory_order_release);
+    return true;
+}
+
+// 任务描述的序列化：模式串列表，随后是每个工作进程的(文档下标, 路径)列表
+void PutU64(std::string& out, uint64_t value) {
+    out.append(reinterpret_cast<const char*>(&value), sizeof(value));
+}
+
+void PutString(std::string& out, const std::string& value) {
+    PutU64(out, value.size());
+    out.append(value);
+}
+
+uint64_t GetU64(const char*& in) {
+    uint64_t value;
+    std::memcpy(&value, in, sizeof(value));
+    in += sizeof(value);
+    return value;
+}
+
+std::string GetString(const char*& in) {
+    uint64_t len = GetU64(in);
+    std::string value(in, len);
+    in += len;
+    return value;
+}
+
+// 解析形如"0-3,8-11"的CPU列表
+std::vector<int> ParseCpuList(const std::string& list) {
+    std::vector<int> cpus;
+    size_t i = 0;
+    while (i < list.size()) {
+        size_t comma = list.find(',', i);
+        std::string item = list.substr(i, comma == std::string::npos ? std::string::npos : comma - i);
+        size_t dash = item.find('-');
+        try {
+            int lo = std::stoi(item.substr(0, dash));
+            int hi = dash == std::string::npos ? lo : std::stoi(item.substr(dash + 1));
+            for (int c = lo; c <= hi; ++c) {
+                cpus.push_back(c);
+            }
+        } catch (const std::exception&) {
+            // 忽略无法解析的片段
+        }
+        if (comma == std::string::npos) {
+            break;
+        }
+        i = comma + 1;
+    }
+    return cpus;
+}
+
+// 系统NUMA节点数，无法读取时视为1
+int NumaNodeCount() {
+    int nodes = 0;
+    std::error_code ec;
+    for (const auto& entry : fs::directory_iterator("/sys/devices/system/node", ec)) {
+        std::string name = entry.path().filename().string();
+        if (name.size() > 4 && name.compare(0, 4, "node") == 0 && std::isdigit(static_cast<unsigned char>(name[4]))) {
+            ++nodes;
+        }
+    }
+    return std::max(nodes, 1);
+}
+
+// 把工作进程绑定到其NUMA节点的CPU上（同节点的多个工作进程再平分），返回可用CPU数
+int BindWorker(int worker_id, int workers) {
+    cpu_set_t allowed;
+    CPU_ZERO(&allowed);
+    if (sched_getaffinity(0, sizeof(allowed), &allowed) != 0) {
+        return omp_get_max_threads();
+    }
+
+    int nodes = NumaNodeCount();
+    int node = worker_id % nodes;
+    std::ifstream cpulist_file("/sys/devices/system/node/node" + std::to_string(node) + "/cpulist");
+    std::string cpulist;
+    std::getline(cpulist_file, cpulist);
+
+    std::vector<int> cpus;
+    for (int c : ParseCpuList(cpulist)) {
+        if (c < CPU_SETSIZE && CPU_ISSET(c, &allowed)) {
+            cpus.push_back(c);
+        }
+    }
+    if (cpus.empty()) {
+        for (int c = 0; c < CPU_SETSIZE; ++c) {
+            if (CPU_ISSET(c, &allowed)) {
+                cpus.push_back(c);
+            }
+        }
+    }
+    if (cpus.empty()) {
+        return omp_get_max_threads();
+    }
+
+    int peers = (workers - node + nodes - 1) / nodes;
+    int rank = worker_id / nodes;
+    size_t begin = cpus.size() * rank / peers;
+    size_t end = cpus.size() * (rank + 1) / peers;
+    if (begin == end) {
+        // CPU少于工作进程数时共享一个CPU
+        begin = rank % cpus.size();
+        end = begin + 1;
+    }
+
+    cpu_set_t mask;
+    CPU_ZERO(&mask);
+    for (size_t i = begin; i < end; ++i) {
+        CPU_SET(cpus[i], &mask);
+    }
+    sched_setaffinity(0, sizeof(mask), &mask);
+    return static_cast<int>(end - begin);
+}
+
+bool ReadDocument(const std::string& file_path, std::string& content) {
+    std::ifstream file(file_path, std::ios::in | std::ios::binary);
+    if (!file.is_open()) {
+        std::cerr << "Error: 无法打开文档 " << file_path << std::endl;
+        return false;
+    }
+    content.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+    return true;
+}
+
+} // namespace
+
+ShardedSearch::ShardedSearch(int workers, size_t ring_bytes)
+    : workers(workers > 0 ? workers : NumaNodeCount()), ring_bytes(4096) {
+    // 环形缓冲区大小取不小于ring_bytes的2的幂，便于取模
+    while (this->ring_bytes < ring_bytes) {
+        this->ring_bytes <<= 1;
+    }
+}
+
+std::vector<std::vector<size_t>> ShardedSearch::SplitShards(const std::vector<size_t>& sizes, int shards) {
+    shards = std::max(shards, 1);
+    std::vector<size_t> order(sizes.size());
+    for (size_t i = 0; i < order.size(); ++i) {
+        order[i] = i;
+    }
+    std::stable_sort(order.begin(), order.end(), [&sizes](size_t a, size_t b) {
+        return sizes[a] > sizes[b];
+    });
+
+    std::vector<std::vector<size_t>> result(shards);
+    std::vector<size_t> load(shards, 0);
+    for (size_t doc : order) {
+        int lightest = std::min_element(load.begin(), load.end()) - load.begin();
+        result[lightest].push_back(doc);
+        load[lightest] += sizes[doc];
+    }
+    // 分片内按原顺序处理
+    for (auto& shard : result) {
+        std::sort(shard.begin(), shard.end());
+    }
+    return result;
+}
+
+bool ShardedSearch::run(const std::vector<std::string>& documents, const std::vector<std::string>& patterns,
+                        std::map<std::string, std::vector<PositionList>>& results) {
+    results.clear();
+    if (documents.empty()) {
+        return true;
+    }
+
+    // 1. 按字节数均衡分片
+    std::vector<size_t> sizes(documents.size());
+    for (size_t i = 0; i < documents.size(); ++i) {
+        std::error_code ec;
+        uintmax_t size = fs::file_size(documents[i], ec);
+        sizes[i] = ec ? 0 : static_cast<size_t>(size);
+    }
+    int shard_count = static_cast<int>(std::min<size_t>(workers, documents.size()));
+    std::vector<std::vector<size_t>> shards = SplitShards(sizes, shard_count);
+
+    // 2. 序列化任务描述
+    std::string job;
+    PutU64(job, patterns.size());
+    for (const auto& pattern : patterns) {
+        PutString(job, pattern);
+    }
+    for (const auto& shard : shards) {
+        PutU64(job, shard.size());
+        for (size_t doc : shard) {
+            PutU64(job, doc);
+            PutString(job, documents[doc]);
+        }
+    }
+
+    // 3. 创建共享内存：头部 | 各工作进程的环形缓冲区 | 任务描述
+    size_t rings_offset = AlignUp(sizeof(ShmHeader), 64);
+    size_t job_offset = rings_offset + shard_count * (sizeof(RingHeader) + ring_bytes);
+    size_t total = job_offset + job.size();
+
+    const std::string shm_name = "/psm_shard_" + std::to_string(getpid());
+    int fd = shm_open(shm_name.c_str(), O_CREAT | O_EXCL | O_RDWR, 0600);
+    if (fd < 0) {
+        std::cerr << "Error: 无法创建共享内存 " << shm_name << " " << std::strerror(errno) << std::endl;
+        return false;
+    }
+    if (ftruncate(fd, total) != 0) {
+        std::cerr << "Error: 无法设置共享内存大小 " << std::strerror(errno) << std::endl;
+        close(fd);
+        shm_unlink(shm_name.c_str());
+        return false;
+    }
+    char* base = static_cast<char*>(mmap(nullptr, total, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0));
+    close(fd);
+    if (base == MAP_FAILED) {
+        std::cerr << "Error: 无法映射共享内存 " << std::strerror(errno) << std::endl;
+        shm_unlink(shm_name.c_str());
+        return false;
+    }
+
+    ShmHeader* header = reinterpret_cast<ShmHeader*>(base);
+    header->workers = shard_count;
+    header->ring_bytes = ring_bytes;
+    header->rings_offset = rings_offset;
+    header->job_offset = job_offset;
+    header->job_bytes = job.size();
+    header->coordinator = getpid();
+    for (int w = 0; w < shard_count; ++w) {
+        RingHeader* ring = new (RingAt(base, header, w)) RingHeader;
+        ring->head.store(0, std::memory_order_relaxed);
+        ring->tail.store(0, std::memory_order_relaxed);
+    }
+    std::memcpy(base + job_offset, job.data(), job.size());
+    header->magic = kMagic;
+
+    // 4. 重新执行本程序作为工作进程（fork后的子进程无法安全使用OpenMP）
+    std::error_code ec;
+    const std::string exe = fs::read_symlink("/proc/self/exe", ec).string();
+    std::vector<pid_t> pids;
+    bool ok = !ec;
+    for (int w = 0; ok && w < shard_count; ++w) {
+        std::string id = std::to_string(w);
+        char* argv[] = {const_cast<char*>(exe.c_str()), const_cast<char*>(kWorkerFlag),
+                        const_cast<char*>(shm_name.c_str()), const_cast<char*>(id.c_str()), nullptr};
+        pid_t pid;
+        if (posix_spawn(&pid, exe.c_str(), nullptr, nullptr, argv, environ) != 0) {
+            ok = false;
+            break;
+        }
+        pids.push_back(pid);
+    }
+    if (!ok) {
+        std::cerr << "Error: 无法启动工作进程 " << exe << std::endl;
+        for (pid_t pid : pids) {
+            kill(pid, SIGTERM);
+            waitpid(pid, nullptr, 0);
+        }
+        munmap(base, total);
+        shm_unlink(shm_name.c_str());
+        return false;
+    }
+
+    // 5. 轮询各环形缓冲区直到所有工作进程退出且数据取尽
+    std::vector<std::vector<PositionList>> hits(documents.size());
+    for (size_t i = 0; i < documents.size(); ++i) {
+        hits[i].assign(patterns.size(), PositionList(sizes[i]));
+    }
+    std::vector<char> failed(documents.size(), 0);
+    size_t alive = pids.size();
+    // 无数据时指数退避，避免与工作进程争用CPU
+    const useconds_t min_idle = 50, max_idle = 5000;
+    useconds_t idle = min_idle;
+    while (true) {
+        bool got = false;
+        for (int w = 0; w < shard_count; ++w) {
+            got |= DrainRing(RingAt(base, header, w), ring_bytes, hits, failed);
+        }
+        if (got) {
+            idle = min_idle;
+            continue;
+        }
+        if (alive == 0) {
+            break;
+        }
+        for (pid_t& pid : pids) {
+            int status;
+            if (pid > 0 && waitpid(pid, &status, WNOHANG) == pid) {
+                if (!WIFEXITED(status) || WEXITSTATUS(status) != 0) {
+                    std::cerr << "Error: 工作进程 " << pid << " 异常退出" << std::endl;
+                    ok = false;
+                }
+                pid = 0;
+                --alive;
+            }
+        }
+        if (alive > 0) {
+            usleep(idle);
+            idle = std::min(idle * 2, max_idle);
+        }
+    }
+
+    munmap(base, total);
+    shm_unlink(shm_name.c_str());
+    if (!ok) {
+        return false;
+    }
+
+    // 6. 按文档路径汇总，读取失败的文档不出现在结果中
+    for (size_t i = 0; i < documents.size(); ++i) {
+        if (failed[i]) {
+            continue;
+        }
+        results[documents[i]] = std::move(hits[i]);
+    }
+    return true;
+}
+
+int ShardedSearch::RunWorker(const std::string& shm_name, int worker_id, StringMatcher* matcher) {
+    int fd = shm_open(shm_name.c_str(), O_RDWR, 0);
+    if (fd < 0) {
+        std::cerr << "Error: 工作进程无法打开共享内存 " << shm_name << std::endl;
+        return 1;
+    }
+    struct stat st;
+    if (fstat(fd, &st) != 0) {
+        close(fd);
+        return 1;
+    }
+    size_t total = st.st_size;
+    char* base = static_cast<char*>(mmap(nullptr, total, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0));
+    close(fd);
+    if (base == MAP_FAILED) {
+        std::cerr << "Error: 工作进程无法映射共享内存 " << shm_name << std::endl;
+        return 1;
+    }
+    const ShmHeader* header = reinterpret_cast<const ShmHeader*>(base);
+    if (header->magic != kMagic || worker_id < 0 || static_cast<uint64_t>(worker_id) >= header->workers) {
+        std::cerr << "Error: 共享内存内容无效 " << shm_name << std::endl;
+        munmap(base, total);
+        return 1;
+    }
+
+    pid_t coordinator = static_cast<pid_t>(header->coordinator);
+    if (!CoordinatorAlive(coordinator)) {
+        std::cerr << "Error: 协调进程已退出 " << shm_name << std::endl;
+        munmap(base, total);
+        shm_unlink(shm_name.c_str());
+        return 1;
+    }
+
+    // 解析任务描述，跳过其他工作进程的分片
+    const char* in = base + header->job_offset;
+    std::vector<std::string> patterns(GetU64(in));
+    for (auto& pattern : patterns) {
+        pattern = GetString(in);
+    }
+    std::vector<std::pair<uint64_t, std::string>> docs;
+    for (int w = 0; w <= worker_id; ++w) {
+        uint64_t count = GetU64(in);
+        docs.clear();
+        for (uint64_t i = 0; i < count; ++i) {
+            uint64_t doc = GetU64(in);
+            docs.emplace_back(doc, GetString(in));
+        }
+    }
+
+    omp_set_num_threads(BindWorker(worker_id, static_cast<int>(header->workers)));
+
+    RingHeader* ring = RingAt(base, header, worker_id);
+    size_t cap = header->ring_bytes;
+    // 单条记录不超过半个缓冲区，避免与协调进程互相等待
+    size_t max_bytes = cap / 2 - sizeof(HitRecord);
+
+    std::vector<size_t> positions;
+    std::vector<uint32_t> narrow;
+    bool orphaned = false;
+    for (const auto& [doc, path] : docs) {
+        if (orphaned || !CoordinatorAlive(coordinator)) {
+            orphaned = true;
+            break;
+        }
+        std::string text;
+        if (!ReadDocument(path, text)) {
+            // 通知协调进程该文档读取失败
+            HitRecord rec;
+            rec.doc = static_cast<uint32_t>(doc);
+            rec.pattern = kFailedDocument;
+            rec.count = 0;
+            rec.width = 0;
+            orphaned = !PushRecord(ring, cap, rec, nullptr, coordinator);
+            continue;
+        }
+        // 4GB以内的文档按32位偏移传输
+        uint32_t width = text.size() <= kOffset32Limit ? sizeof(uint32_t) : sizeof(uint64_t);
+        size_t max_chunk = max_bytes / width;
+        for (size_t p = 0; !orphaned && p < patterns.size(); ++p) {
+            matcher->match(text, patterns[p], positions);
+            // 协调进程按升序追加位置
+            if (!std::is_sorted(positions.begin(), positions.end())) {
+                std::sort(positions.begin(), positions.end());
+            }
+            const void* payload = positions.data();
+            if (width == sizeof(uint32_t)) {
+                narrow.assign(positions.begin(), positions.end());
+                payload = narrow.data();
+            }
+            for (size_t sent = 0; !orphaned && sent < positions.size(); sent += max_chunk) {
+                HitRecord rec;
+                rec.doc = static_cast<uint32_t>(doc);
+                rec.pattern = static_cast<uint32_t>(p);
+                rec.count = static_cast<uint32_t>(std::min(max_chunk, positions.size() - sent));
+                rec.width = width;
+                orphaned = !PushRecord(ring, cap, rec, static_cast<const char*>(payload) + sent * width, coordinator);
+            }
+        }
+    }
+
+    munmap(base, total);
+    if (orphaned) {
+        // 协调进程已退出，代为删除共享内存
+        std::cerr << "Error: 协调进程已退出，工作进程 " << worker_id << " 终止" << std::endl;
+        shm_unlink(shm_name.c_str());
+        return 1;
+    }
+    return 0;
+}
+
+void ShardedSearch::Test_SplitShards() {
+    std::cout << "Testing Split Shards.\n";
+    const std::vector<size_t> sizes = {700, 100, 300, 300, 200, 500, 400};
+    std::vector<std::vector<size_t>> shards = SplitShards(sizes, 3);
+    for (size_t s = 0; s < shards.size(); ++s) {
+        size_t bytes = 0;
+        std::cout << "shard " << s << ":";
+        for (size_t doc : shards[s]) {
+            std::cout << " " << doc;
+            bytes += sizes[doc];
+        }
+        std::cout << " (" << bytes << " bytes)\n";
+    }
+}
+
+// 经run()完整检索临时文档集，与进程内KMP结果比对；宿主程序需以KMPMatcher处理kWorkerFlag
+void ShardedSearch::Test_ShardedSearch() {
+    std::cout << "Testing Sharded Search (" << workers << " workers, " << ring_bytes << " bytes ring).\n";
+    const fs::path dir = fs::temp_directory_path() / ("psm_shard_test_" + std::to_string(getpid()));
+    fs::create_directories(dir);
+
+    // 生成长短不一的文档，高频模式串的命中数远超单条记录容量，覆盖分块传输与缓冲区回绕
+    std::vector<std::string> documents;
+    uint32_t seed = 12345;
+    for (int d = 0; d < 7; ++d) {
+        std::string text((d + 1) * 20000, ' ');
+        for (char& c : text) {
+            seed = seed * 1103515245 + 12345;
+            c = "ab "[(seed >> 16) % 3];
+        }
+        documents.push_back((dir / ("doc" + std::to_string(d) + ".txt")).string());
+        std::ofstream(documents.back(), std::ios::binary) << text;
+    }
+    documents.push_back((dir / "missing.txt").string()); // 不存在的文档应被排除
+    const std::vector<std::string> patterns = {"a", "ab", "b ab", "aaaaaaaa", "x"};
+
+    std::map<std::string, std::vector<PositionList>> results;
+    bool ok = run(documents, patterns, results);
+    size_t mismatches = 0, total = 0;
+    if (ok) {
+        KMPMatcher kmp;
+        for (size_t d = 0; d + 1 < documents.size(); ++d) {
+            std::string text;
+            ReadDocument(documents[d], text);
+            for (size_t p = 0; p < patterns.size(); ++p) {
+                std::vector<size_t> expected, actual;
+                kmp.match(text, patterns[p], expected);
+                if (results.count(documents[d])) {
+                    results[documents[d]][p].decode(actual);
+                }
+                total += expected.size();
+                mismatches += expected != actual;
+            }
+        }
+        mismatches += results.count(documents.back());
+    }
+    fs::remove_all(dir);
+
+    std::cout << "run: " << (ok ? "ok" : "failed") << ", documents: " << results.size()
+              << ", hits: " << total << ", mismatches: " << mismatches << '\n';
+}
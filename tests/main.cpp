@@ -1,5 +1,7 @@
 #include "kmp_matcher.h"
 #include "parallel_matcher.h"
+#include "packed_matcher.h"
+#include "shard_search.h"
 #include <iostream>
 #include <fstream>
 #include <filesystem>
@@ -43,6 +45,29 @@ void Test_ParallelMatch(){
    pm.Test_ParallelMatch();
 }
 
+void Test_TwoPass(){
+   ParallelMatcher pm;
+   pm.Test_TwoPass();
+}
+
+void Test_PackedMatch(){
+   PackedMatcher<2> pm2;
+   pm2.Test_PackedMatch();
+   PackedMatcher<4> pm4;
+   pm4.Test_PackedMatch();
+}
+
+void Test_SplitShards(){
+   ShardedSearch search;
+   search.Test_SplitShards();
+}
+
+void Test_ShardedSearch(){
+   // 小缓冲区迫使命中位置分块传输
+   ShardedSearch search(3, 4096);
+   search.Test_ShardedSearch();
+}
+
 // 读取文本文件到字符串
 bool readTextFile(const std::string& file_path, std::string& content) {
     std::ifstream file(file_path, std::ios::in);
@@ -189,10 +214,19 @@ void test_omp(){
     }
 }
 
-int main() {
+int main(int argc, char* argv[]) {
+    // 分片检索的工作进程入口（Test_ShardedSearch以KMP结果为基准）
+    if (argc == 4 && std::string(argv[1]) == ShardedSearch::kWorkerFlag) {
+        KMPMatcher kmp;
+        return ShardedSearch::RunWorker(argv[2], std::stoi(argv[3]), &kmp);
+    }
     Test_Time();
+    Test_ShardedSearch();
+    Test_TwoPass();
+    Test_PackedMatch();
     // Test_MatchNonPeriodic();
     // Test_ParallelMatch();
+    // Test_SplitShards();
     // Test_GetWitnessArray();
     return 0;
 }
\ No newline at end of file